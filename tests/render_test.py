@@ -0,0 +1,391 @@
+#!/usr/bin/env python3
+"""
+Headless render tests for the habits TUI.
+
+Each scenario starts the binary on a pseudo-terminal with a fixed clock and
+a copy of tests/fixtures/habits.csv as its data file, types a scripted key
+sequence, and feeds everything the program writes through a small VT100
+emulator. The final screen is compared with tests/snapshots/<name>.txt, and
+the bytes written to the terminal are checked against tests/budgets.json.
+CPU time per frame (one frame = startup or one key) is reported and checked
+against a generous fixed limit.
+
+    python3 tests/render_test.py ./habits            # check
+    python3 tests/render_test.py --update ./habits   # accept new output
+"""
+import argparse
+import difflib
+import fcntl
+import json
+import math
+import os
+import pty
+import select
+import shutil
+import signal
+import struct
+import sys
+import tempfile
+import termios
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SNAPSHOTS = os.path.join(HERE, "snapshots")
+FIXTURE = os.path.join(HERE, "fixtures", "habits.csv")
+BUDGETS = os.path.join(HERE, "budgets.json")
+
+NOW = 1741780800          # 2025-03-12 12:00 UTC, a Wednesday
+QUIET_SECONDS = 0.15      # Output is done once the terminal is silent this long
+BYTE_SLACK = 1.2          # Budgets allow 20% growth over the accepted output
+CPU_MS_PER_FRAME = 20.0
+
+ESC = "\x1b"
+ENTER = "\n"
+
+# name: (keys, rows, cols)
+SCENARIOS = {
+    "dashboard":       ([], 24, 80),
+    "toggle":          (["j", ENTER, "h", ENTER], 24, 80),
+    "calendar":        (["c", "l", "l", ENTER], 24, 80),
+    "confirm_delete":  (["d"], 24, 80),
+    "delete_cancel":   (["d", "n"], 24, 80),
+    "delete_confirm":  (["d", "y"], 24, 80),
+    "add_habit":       (["1", "Walk", ENTER], 24, 80),
+    "rename_habit":    (["r", "\x7f\x7f", "XY", ENTER], 24, 80),
+    "reminder":        (["6", "07:30", ENTER], 24, 80),
+    "stats":           (["7"], 24, 80),
+    "profile_picker":  (["p"], 24, 80),
+    "too_small":       ([], 12, 50),
+}
+
+# VT100 special graphics, reduced to ASCII so snapshots stay readable
+LINE_DRAWING = {
+    "q": "-", "x": "|", "l": "+", "k": "+", "m": "+", "j": "+",
+    "t": "+", "u": "+", "v": "+", "w": "+", "n": "+",
+    "-": "^", ".": "v", ",": "<", "+": ">", "`": "*", "a": "#", "~": "o",
+}
+
+
+class Screen:
+    """Just enough of a VT100/xterm to follow what ncurses sends."""
+
+    def __init__(self, rows, cols):
+        self.rows, self.cols = rows, cols
+        self.grid = [[" "] * cols for _ in range(rows)]
+        self.y = self.x = 0
+        self.top, self.bottom = 0, rows - 1
+        self.saved = (0, 0)
+        self.charsets = ["B", "B"]
+        self.shift = 0
+        self.last = " "
+        self.wrap_pending = False
+        self.bells = 0
+        self.pending = b""
+
+    def text(self):
+        return "\n".join("".join(row).rstrip() for row in self.grid) + "\n"
+
+    def feed(self, data):
+        data = self.pending + data
+        self.pending = b""
+        i = 0
+        while i < len(data):
+            c = data[i]
+            if c == 0x1B:
+                used = self._escape(data, i)
+                if used == 0:
+                    self.pending = data[i:]
+                    return
+                i += used
+                continue
+            i += 1
+            if c == 0x07:
+                self.bells += 1
+            elif c == 0x08:
+                self.x = max(0, self.x - 1)
+                self.wrap_pending = False
+            elif c == 0x09:
+                self.x = min(self.cols - 1, (self.x // 8 + 1) * 8)
+            elif c in (0x0A, 0x0B, 0x0C):
+                self._linefeed()
+            elif c == 0x0D:
+                self.x = 0
+                self.wrap_pending = False
+            elif c == 0x0E:
+                self.shift = 1
+            elif c == 0x0F:
+                self.shift = 0
+            elif c >= 0x20:
+                self._put(chr(c))
+
+    def _put(self, ch):
+        self.last = ch  # REP repeats the byte, before charset mapping
+        if self.charsets[self.shift] == "0":
+            ch = LINE_DRAWING.get(ch, ch)
+        if self.wrap_pending:
+            self.x = 0
+            self._linefeed()
+        self.grid[self.y][self.x] = ch
+        if self.x == self.cols - 1:
+            self.wrap_pending = True
+        else:
+            self.x += 1
+
+    def _linefeed(self):
+        self.wrap_pending = False
+        if self.y == self.bottom:
+            self._scroll_up(1)
+        elif self.y < self.rows - 1:
+            self.y += 1
+
+    def _scroll_up(self, n):
+        for _ in range(n):
+            del self.grid[self.top]
+            self.grid.insert(self.bottom, [" "] * self.cols)
+
+    def _scroll_down(self, n):
+        for _ in range(n):
+            del self.grid[self.bottom]
+            self.grid.insert(self.top, [" "] * self.cols)
+
+    def _escape(self, data, i):
+        """Handles the sequence at data[i]; returns its length, 0 if incomplete."""
+        if i + 1 >= len(data):
+            return 0
+        kind = chr(data[i + 1])
+        if kind == "[":
+            j = i + 2
+            while j < len(data) and not 0x40 <= data[j] <= 0x7E:
+                j += 1
+            if j >= len(data):
+                return 0
+            self._csi(data[i + 2:j].decode("latin-1"), chr(data[j]))
+            return j - i + 1
+        if kind in "()":
+            if i + 2 >= len(data):
+                return 0
+            self.charsets["()".index(kind)] = chr(data[i + 2])
+            return 3
+        if kind == "]":  # OSC, ends with BEL or ST
+            j = i + 2
+            while j < len(data) and data[j] != 0x07 and data[j:j + 2] != b"\x1b\\":
+                j += 1
+            if j >= len(data):
+                return 0
+            return j - i + (1 if data[j] == 0x07 else 2)
+        if kind == "7":
+            self.saved = (self.y, self.x)
+        elif kind == "8":
+            self.y, self.x = self.saved
+        elif kind == "M":
+            if self.y == self.top:
+                self._scroll_down(1)
+            elif self.y > 0:
+                self.y -= 1
+        elif kind == "D":
+            self._linefeed()
+        elif kind == "E":
+            self.x = 0
+            self._linefeed()
+        elif kind == "c":
+            self.__init__(self.rows, self.cols)
+        return 2  # "=", ">" and anything else without arguments
+
+    def _csi(self, params, final):
+        private = params.startswith(("?", ">"))
+        if private:
+            return  # Mode switches (cursor visibility, keypad, ...) don't draw
+        args = [int(p) if p.isdigit() else 0 for p in params.split(";")] if params else []
+
+        def arg(n, default=1):
+            return args[n] if len(args) > n and args[n] else default
+
+        self.wrap_pending = False
+        row = self.grid[self.y]
+        if final in "Hf":
+            self.y = min(self.rows - 1, arg(0) - 1)
+            self.x = min(self.cols - 1, arg(1) - 1)
+        elif final == "A":
+            self.y = max(0, self.y - arg(0))
+        elif final in "Be":
+            self.y = min(self.rows - 1, self.y + arg(0))
+        elif final in "Ca":
+            self.x = min(self.cols - 1, self.x + arg(0))
+        elif final == "D":
+            self.x = max(0, self.x - arg(0))
+        elif final == "E":
+            self.x, self.y = 0, min(self.rows - 1, self.y + arg(0))
+        elif final == "F":
+            self.x, self.y = 0, max(0, self.y - arg(0))
+        elif final in "G`":
+            self.x = min(self.cols - 1, arg(0) - 1)
+        elif final == "d":
+            self.y = min(self.rows - 1, arg(0) - 1)
+        elif final == "J":
+            mode = arg(0, 0)
+            if mode == 0:
+                row[self.x:] = [" "] * (self.cols - self.x)
+                for r in range(self.y + 1, self.rows):
+                    self.grid[r] = [" "] * self.cols
+            elif mode == 1:
+                row[:self.x + 1] = [" "] * (self.x + 1)
+                for r in range(self.y):
+                    self.grid[r] = [" "] * self.cols
+            else:
+                self.grid = [[" "] * self.cols for _ in range(self.rows)]
+        elif final == "K":
+            mode = arg(0, 0)
+            if mode == 0:
+                row[self.x:] = [" "] * (self.cols - self.x)
+            elif mode == 1:
+                row[:self.x + 1] = [" "] * (self.x + 1)
+            else:
+                row[:] = [" "] * self.cols
+        elif final == "X":
+            n = min(arg(0), self.cols - self.x)
+            row[self.x:self.x + n] = [" "] * n
+        elif final == "@":
+            n = min(arg(0), self.cols - self.x)
+            row[self.x:self.x] = [" "] * n
+            del row[self.cols:]
+        elif final == "P":
+            n = min(arg(0), self.cols - self.x)
+            del row[self.x:self.x + n]
+            row.extend([" "] * n)
+        elif final in "LM":
+            if self.top <= self.y <= self.bottom:
+                saved_top, self.top = self.top, self.y
+                (self._scroll_down if final == "L" else self._scroll_up)(arg(0))
+                self.top = saved_top
+        elif final == "S":
+            self._scroll_up(arg(0))
+        elif final == "T":
+            self._scroll_down(arg(0))
+        elif final == "b":
+            for _ in range(arg(0)):
+                self._put(self.last)
+        elif final == "r":
+            self.top = arg(0) - 1
+            self.bottom = min(self.rows - 1, arg(1, self.rows) - 1)
+            self.y = self.x = 0
+        # "m" (colours and attributes), "h"/"l" modes and reports are ignored
+
+
+def read_until_quiet(fd, limit=5.0):
+    data = b""
+    deadline = time.monotonic() + limit
+    while time.monotonic() < deadline:
+        ready, _, _ = select.select([fd], [], [], QUIET_SECONDS)
+        if not ready:
+            break
+        try:
+            chunk = os.read(fd, 65536)
+        except OSError:
+            break
+        if not chunk:
+            break
+        data += chunk
+    return data
+
+
+def run(binary, keys, rows, cols):
+    home = tempfile.mkdtemp(prefix="habits-render-")
+    shutil.copy(FIXTURE, os.path.join(home, ".habits.csv"))
+    env = {
+        "HOME": home,
+        "PATH": os.environ.get("PATH", "/usr/bin:/bin"),
+        "TERM": "xterm-256color",
+        "LC_ALL": "C",
+        "TZ": "UTC",
+        "ESCDELAY": "25",
+        "HABITS_NOW": str(NOW),
+    }
+    pid, fd = pty.fork()
+    if pid == 0:
+        try:
+            fcntl.ioctl(0, termios.TIOCSWINSZ, struct.pack("HHHH", rows, cols, 0, 0))
+            os.execve(binary, [binary], env)
+        finally:
+            os._exit(127)
+
+    screen = Screen(rows, cols)
+    frame_bytes = []
+    try:
+        for key in [None] + keys:
+            if key is not None:
+                os.write(fd, key.encode())
+            data = read_until_quiet(fd)
+            screen.feed(data)
+            frame_bytes.append(len(data))
+    finally:
+        os.kill(pid, signal.SIGKILL)
+        _, _, usage = os.wait4(pid, 0)
+        os.close(fd)
+        shutil.rmtree(home, ignore_errors=True)
+
+    cpu_ms = (usage.ru_utime + usage.ru_stime) * 1000
+    return screen.text(), frame_bytes, cpu_ms
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("binary")
+    parser.add_argument("--update", action="store_true",
+                        help="rewrite snapshots and byte budgets from this run")
+    parser.add_argument("scenarios", nargs="*", help="only run these scenarios")
+    opts = parser.parse_args()
+
+    binary = os.path.abspath(opts.binary)
+    budgets = {}
+    if os.path.exists(BUDGETS):
+        with open(BUDGETS) as f:
+            budgets = json.load(f)
+
+    names = opts.scenarios or list(SCENARIOS)
+    failures = 0
+    print("%-16s %8s %8s %10s  %s" % ("scenario", "bytes", "budget", "cpu/frame", "result"))
+    for name in names:
+        keys, rows, cols = SCENARIOS[name]
+        screen, frame_bytes, cpu_ms = run(binary, keys, rows, cols)
+        total = sum(frame_bytes)
+        per_frame = cpu_ms / len(frame_bytes)
+        path = os.path.join(SNAPSHOTS, name + ".txt")
+
+        if opts.update:
+            os.makedirs(SNAPSHOTS, exist_ok=True)
+            with open(path, "w") as f:
+                f.write(screen)
+            budgets[name] = {"bytes": math.ceil(total * BYTE_SLACK)}
+            print("%-16s %8d %8d %8.2fms  updated" % (name, total, budgets[name]["bytes"], per_frame))
+            continue
+
+        problems = []
+        expected = open(path).read() if os.path.exists(path) else None
+        if expected != screen:
+            problems.append("snapshot")
+        budget = budgets.get(name, {}).get("bytes")
+        if budget is None or total > budget:
+            problems.append("bytes")
+        if per_frame > CPU_MS_PER_FRAME:
+            problems.append("cpu")
+
+        print("%-16s %8d %8s %8.2fms  %s" % (name, total, budget, per_frame,
+                                            "FAIL (" + ", ".join(problems) + ")" if problems else "ok"))
+        if "snapshot" in problems:
+            sys.stdout.writelines(difflib.unified_diff(
+                (expected or "").splitlines(True), screen.splitlines(True),
+                "snapshots/" + name + ".txt", "rendered"))
+        failures += bool(problems)
+
+    if opts.update:
+        with open(BUDGETS, "w") as f:
+            json.dump(budgets, f, indent=4, sort_keys=True)
+            f.write("\n")
+    elif failures:
+        print("%d of %d scenarios failed" % (failures, len(names)))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -6,11 +6,21 @@
 #include <string.h>
 #include <time.h>
 #include <limits.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <ctype.h>
+#include <dirent.h>
+#ifdef USE_SQLITE
+    #include <sqlite3.h>
+#endif
 
 #ifndef PATH_MAX
     #define PATH_MAX 4096
 #endif
-#define HABITS_FILE ".habits.csv"
+#define HABITS_PREFIX ".habits"
+#define DEFAULT_PROFILE "default"
 #define ESC_HINT "<- Esc"
 
 enum { 
@@ -22,7 +32,7 @@ enum {
     dashboard_length = 49,
     calendar_length = 20,
     calendar_height = 8,
-    action_bar_length = 57,
+    action_bar_length = 80,
     max_habits_amount = 10,
     colors_max = 256,
     habit_fields = 4,
@@ -30,6 +40,18 @@ enum {
     days_in_year = 366,
     days_in_week = 7,
     weeks_in_year = 53,
+    rolling_window = 30,
+    minutes_in_hour = 60,
+    minutes_in_day = 1440,
+    no_reminder = -1,
+    profile_cache_size = 4,
+    profiles_max = 20,
+    months_in_year = 12,
+    import_progress_rows = 1 << 20,
+    dropped_names_max = 32,
+    history_words = (days_in_year + 63) / 64,
+    min_days_for_pattern = 3,
+    bench_rounds = 2000,
 };
 
 enum menu_indices {
@@ -38,6 +60,8 @@ enum menu_indices {
     idx_rename,
     idx_calendar,
     idx_quit,
+    idx_remind,
+    idx_stats,
     menu_count
 };
 
@@ -46,12 +70,19 @@ typedef struct Habit {
     time_t last_done;
     int year;
     bool history[days_in_year];
+    int remind_at; // Minutes past midnight, or no_reminder
 } Habit;
 
+// $HABITS_NOW (seconds since the epoch) pins the clock for scripted runs
+static time_t current_time() {
+    const char *fixed = getenv("HABITS_NOW");
+    return fixed ? (time_t)strtoll(fixed, NULL, 10) : time(NULL);
+}
+
 static void mark_habit_done(Habit *habit, int yday) {
     habit->history[yday] = !habit->history[yday];
     if(habit->history[yday]) 
-        habit->last_done = time(NULL);
+        habit->last_done = current_time();
     else
         habit->last_done = 0;
 }
@@ -71,6 +102,247 @@ static int get_streak(Habit habit, int today)
 
 }
 
+static int get_longest_streak(Habit habit, int today)
+{
+    int longest = 0, run = 0;
+    for(int day = 0; day <= today; day++) {
+        run = habit.history[day] ? run + 1 : 0;
+        if(run > longest)
+            longest = run;
+    }
+    return longest;
+}
+
+// Days a `window` ending today really covers; history starts on January 1
+static int window_days(int today, int window)
+{
+    return today + 1 < window ? today + 1 : window;
+}
+
+// Share of the last window_days (up to and including today) marked done
+static double completion_rate(Habit habit, int today, int window)
+{
+    int first = today - window_days(today, window) + 1;
+    int done = 0;
+    for(int day = first; day <= today; day++)
+        if(habit.history[day])
+            done++;
+    return (double)done / (today - first + 1);
+}
+
+static int count_completed(Habit *habits, int total, int day)
+{
+    // Handle index wrapping (just like in draw_habit_item)
+    if(day < 0) day += days_in_year;
+
+    int completed = 0;
+    for(int i = 0; i < total; i++)
+        if(habits[i].history[day])
+            completed++;
+    return completed;
+}
+
+// Done days in the last week minus done days in the week before it
+static int week_trend(Habit habit, int today)
+{
+    int trend = 0;
+    for(int i = 0; i < 2 * days_in_week; i++) {
+        int day = today - i;
+        if(day < 0) break;
+        if(habit.history[day])
+            trend += (i < days_in_week) ? 1 : -1;
+    }
+    return trend;
+}
+
+/*
+ * Pairwise co-occurrence of done days. Each history is packed into a
+ * bitset so a pair costs a few AND + popcounts. Only rows and columns of
+ * habits marked stale are recomputed.
+ */
+typedef struct Correlation {
+    uint64_t bits[max_habits_amount][history_words];
+    int done[max_habits_amount];
+    int together[max_habits_amount][max_habits_amount];
+    bool stale[max_habits_amount];
+} Correlation;
+
+static void invalidate_correlation(Correlation *corr, int habit)
+{
+    corr->stale[habit] = true;
+}
+
+static void invalidate_all_correlations(Correlation *corr)
+{
+    for(int i = 0; i < max_habits_amount; i++)
+        corr->stale[i] = true;
+}
+
+static int count_together(const uint64_t *a, const uint64_t *b)
+{
+    int count = 0;
+    for(int w = 0; w < history_words; w++)
+        count += __builtin_popcountll(a[w] & b[w]);
+    return count;
+}
+
+static void update_correlation(Correlation *corr, Habit *habits, int total)
+{
+    for(int i = 0; i < total; i++) {
+        if(!corr->stale[i]) continue;
+        memset(corr->bits[i], 0, sizeof(corr->bits[i]));
+        for(int day = 0; day < days_in_year; day++)
+            if(habits[i].history[day])
+                corr->bits[i][day / 64] |= (uint64_t)1 << (day % 64);
+        corr->done[i] = count_together(corr->bits[i], corr->bits[i]);
+    }
+    for(int i = 0; i < total; i++) {
+        if(!corr->stale[i]) continue;
+        for(int j = 0; j < total; j++)
+            corr->together[i][j] = corr->together[j][i] =
+                count_together(corr->bits[i], corr->bits[j]);
+    }
+    for(int i = 0; i < total; i++)
+        corr->stale[i] = false;
+}
+
+// A reminder is overdue once its time has passed today and the habit is not done
+static bool is_overdue(Habit *habit, struct tm *now)
+{
+    if(habit->remind_at == no_reminder || habit->history[now->tm_yday])
+        return false;
+    return now->tm_hour * minutes_in_hour + now->tm_min >= habit->remind_at;
+}
+
+// Next wall-clock time strictly after `after` that matches `remind_at`.
+// mktime resolves DST, so the reminder keeps its local time across changes.
+static time_t next_due(int remind_at, time_t after)
+{
+    struct tm t = *localtime(&after);
+    for(int skip = 0; skip < 2; skip++) {
+        struct tm due = t;
+        due.tm_mday += skip;
+        due.tm_hour = remind_at / minutes_in_hour;
+        due.tm_min = remind_at % minutes_in_hour;
+        due.tm_sec = 0;
+        due.tm_isdst = -1;
+        time_t when = mktime(&due);
+        if(when > after)
+            return when;
+    }
+    return after + minutes_in_day * 60;
+}
+
+typedef struct Reminder {
+    time_t due;
+    int habit;
+} Reminder;
+
+// Min-heap of upcoming reminders, earliest first
+typedef struct Scheduler {
+    Reminder heap[max_habits_amount];
+    int size;
+    Habit *habits;
+} Scheduler;
+
+static void scheduler_push(Scheduler *s, Reminder r)
+{
+    int i = s->size++;
+    while(i > 0 && s->heap[(i - 1) / 2].due > r.due) {
+        s->heap[i] = s->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    s->heap[i] = r;
+}
+
+static Reminder scheduler_pop(Scheduler *s)
+{
+    Reminder top = s->heap[0];
+    Reminder last = s->heap[--s->size];
+    int i = 0;
+    while(1) {
+        int child = 2 * i + 1;
+        if(child >= s->size) break;
+        if(child + 1 < s->size && s->heap[child + 1].due < s->heap[child].due)
+            child++;
+        if(last.due <= s->heap[child].due) break;
+        s->heap[i] = s->heap[child];
+        i = child;
+    }
+    if(s->size > 0)
+        s->heap[i] = last;
+    return top;
+}
+
+static void schedule_reminders(Scheduler *s, Habit *habits, int total)
+{
+    time_t now = current_time();
+    s->size = 0;
+    s->habits = habits;
+    for(int i = 0; i < total; i++)
+        if(habits[i].remind_at != no_reminder)
+            scheduler_push(s, (Reminder){ next_due(habits[i].remind_at, now), i });
+}
+
+// Milliseconds until the earliest reminder, or -1 to block until a key press
+static int scheduler_timeout(Scheduler *s)
+{
+    if(s->size == 0) return -1;
+    double wait = difftime(s->heap[0].due, current_time());
+    if(wait <= 0) return 0;
+    if(wait > INT_MAX / 1000) return INT_MAX;
+    return (int)wait * 1000;
+}
+
+// Runs $HABITS_REMINDER_HOOK in the background with $HABIT_NAME set
+static void run_reminder_hook(Habit *habit)
+{
+    const char *hook = getenv("HABITS_REMINDER_HOOK");
+    if(hook == NULL || fork() != 0)
+        return;
+    int null_fd = open("/dev/null", O_RDWR);
+    if(null_fd >= 0) {
+        dup2(null_fd, STDIN_FILENO);
+        dup2(null_fd, STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+    }
+    setsid();
+    setenv("HABIT_NAME", habit->name, 1);
+    execl("/bin/sh", "sh", "-c", hook, (char *)NULL);
+    _exit(127);
+}
+
+// Rings for every reminder that is due and queues its next occurrence
+static void fire_reminders(Scheduler *s)
+{
+    time_t now = current_time();
+    while(s->size > 0 && s->heap[0].due <= now) {
+        Reminder r = scheduler_pop(s);
+        Habit *habit = &s->habits[r.habit];
+        if(is_overdue(habit, localtime(&now))) {
+            beep();
+            run_reminder_hook(habit);
+        }
+        r.due = next_due(habit->remind_at, now);
+        scheduler_push(s, r);
+    }
+}
+
+// Reminders of the open profile; shared so every screen can ring them
+static Scheduler reminders;
+
+// Waits for a key on `win` but wakes for the next reminder, returning ERR
+// after ringing it so the caller can redraw
+static int read_key(WINDOW *win)
+{
+    wtimeout(win, scheduler_timeout(&reminders));
+    int ch = wgetch(win);
+    wtimeout(win, -1);
+    if(ch == ERR)
+        fire_reminders(&reminders);
+    return ch;
+}
+
 static void dimmed_attr(int *attr)
 {
     *attr = COLOR_PAIR(3);
@@ -79,8 +351,10 @@ static void dimmed_attr(int *attr)
 }
 
 static void draw_habit_item(int y, int x, int selected_yday, bool highlighted, Habit habit) {
-    time_t now = time(NULL);
-    int real_today = localtime(&now)->tm_yday;
+    time_t now = current_time();
+    struct tm *t = localtime(&now);
+    int real_today = t->tm_yday;
+    bool overdue = is_overdue(&habit, t);
 
     int day_offset = real_today - selected_yday;
     int target_column = days_in_week - 1 - day_offset;
@@ -113,16 +387,17 @@ static void draw_habit_item(int y, int x, int selected_yday, bool highlighted, H
     // --- IMPROVED STREAK UI END ---
 
     int cur_y, cur_x;
-    if(!highlighted) attron(attr); 
+    int name_attr = overdue ? COLOR_PAIR(5) | A_BOLD : attr;
+    if(!highlighted || overdue) attron(name_attr); 
     printw("%s", habit.name);
-    if(!highlighted) attroff(attr); 
+    if(!highlighted || overdue) attroff(name_attr); 
 
     int checkbox_start_col = x + checkbox_offset;
     getyx(stdscr, cur_y, cur_x);
     
     // Fill remaining space with padding
     if(checkbox_start_col > cur_x) {
-        hline(checkbox_start_col - cur_x, ' ');
+        hline(' ', checkbox_start_col - cur_x);
         move(cur_y, checkbox_start_col);
     }
 
@@ -141,69 +416,460 @@ static void draw_habit_item(int y, int x, int selected_yday, bool highlighted, H
         printw(" %c ", c);
         attroff(attr);
     }
+
+    // Week-over-week trend
+    int trend = week_trend(habit, real_today);
+    addch(' ');
+    if(trend > 0)
+        addch(ACS_UARROW | COLOR_PAIR(2));
+    else if(trend < 0)
+        addch(ACS_DARROW | COLOR_PAIR(5));
+    else {
+        dimmed_attr(&attr);
+        addch('-' | attr);
+    }
 }
 
-static void get_data_path(char *dest) {
+// The default profile lives in ~/.habits.<ext>, others in ~/.habits-<name>.<ext>
+static void get_data_path(char *dest, const char *profile, const char *ext) {
+    char file[name_max_length + 16];
+    if(strcmp(profile, DEFAULT_PROFILE) == 0)
+        snprintf(file, sizeof(file), "%s.%s", HABITS_PREFIX, ext);
+    else
+        snprintf(file, sizeof(file), "%s-%s.%s", HABITS_PREFIX, profile, ext);
+
     const char *home = getenv("HOME");
     if(home == NULL)
-        strncpy(dest, HABITS_FILE, PATH_MAX);
+        strncpy(dest, file, PATH_MAX);
     else
-        snprintf(dest, PATH_MAX, "%s/%s", home, HABITS_FILE);
+        snprintf(dest, PATH_MAX, "%s/%s", home, file);
+
+}
 
+// Fills in the history from a '0'/'1' string, starting over on a new year
+static void parse_history(Habit *habit, const char *s, int current_year) {
+    if(habit->year != current_year) {
+        memset(habit->history, 0, sizeof(habit->history));
+        habit->year = current_year;
+    } else
+        for(int j = 0; j < days_in_year; j++)
+            habit->history[j] = (s[j] == '1');
 }
 
-static void load_habits(Habit *habits, int *current_total) {
+/*
+ * A storage backend knows how to read the whole habit list from its file
+ * and how to write it back. The app itself only talks to load_habits and
+ * upload_to_disk, which dispatch through the selected backend.
+ */
+typedef struct Storage {
+    const char *name;
+    const char *ext;
+    bool (*open)(struct Storage *self, const char *path);
+    int (*load)(struct Storage *self, Habit *habits, int max);
+    bool (*flush)(struct Storage *self, Habit *habits, int total);
+    void (*close)(struct Storage *self);
     char path[PATH_MAX];
-    get_data_path(path);
+    void *handle;
+} Storage;
+
+static bool csv_open(Storage *self, const char *path) {
+    strncpy(self->path, path, PATH_MAX - 1);
+    self->path[PATH_MAX - 1] = '\0';
+    return true;
+}
 
-    FILE *from = fopen(path, "r");
-    if(!from) return;
+static int csv_load(Storage *self, Habit *habits, int max) {
+    FILE *from = fopen(self->path, "r");
+    if(!from) return 0;
     char line[512];
     int i = 0;
 
     char fmt[64];
     char s_fmt[20];
 
-    time_t now = time(NULL);
+    time_t now = current_time();
     int current_year = localtime(&now)->tm_year + 1900;
 
     snprintf(s_fmt, sizeof(s_fmt), "%%%ds", days_in_year);
-    snprintf(fmt, sizeof(fmt), " %%%d[^,],%%ld,%%d,%s", name_max_length - 1, s_fmt);
+    snprintf(fmt, sizeof(fmt), " %%%d[^,],%%ld,%%d,%s,%%d", name_max_length - 1, s_fmt);
 
-    while(fgets(line, sizeof(line), from) && i < max_habits_amount) {
+    while(fgets(line, sizeof(line), from) && i < max) {
         char s[days_in_year + 1];
-        if(sscanf(line, fmt, habits[i].name, &habits[i].last_done, &habits[i].year, s) == habit_fields) {
-            if(habits[i].year != current_year) {
-                memset(habits[i].history, 0, sizeof(habits[i].history));
-                habits[i].year = current_year;
-            } else
-                for(int j = 0; j < days_in_year; j++)
-                    habits[i].history[j] = (s[j] == '1');
+        habits[i].remind_at = no_reminder; // Optional trailing field
+        if(sscanf(line, fmt, habits[i].name, &habits[i].last_done, &habits[i].year, s,
+                  &habits[i].remind_at) >= habit_fields) {
+            parse_history(&habits[i], s, current_year);
             i++;
         }
             
     }
-    *current_total = i;
     fclose(from);
+    return i;
 }
 
-static void upload_to_disk(Habit *habits, int current_total) {
-    char path[PATH_MAX];
-    get_data_path(path);
-
-    FILE *dest = fopen(path, "w");
-    if(!dest) return;
+static bool csv_flush(Storage *self, Habit *habits, int total) {
+    FILE *dest = fopen(self->path, "w");
+    if(!dest) return false;
 
-    for(int i = 0; i < current_total; i++) {
+    for(int i = 0; i < total; i++) {
         fprintf(dest, "%s,%ld,%d,", 
                 habits[i].name, 
                 habits[i].last_done, 
                 habits[i].year);
         for(int j = 0; j < days_in_year; j++)
             fputc(habits[i].history[j] ? '1' : '0', dest);
+        if(habits[i].remind_at != no_reminder)
+            fprintf(dest, ",%d", habits[i].remind_at);
         fputc('\n', dest);
     }
-    fclose(dest);
+    bool ok = !ferror(dest);
+    return fclose(dest) == 0 && ok;
+}
+
+static void csv_close(Storage *self) {
+    (void)self;
+}
+
+#ifdef USE_SQLITE
+/*
+ * One row per habit, keyed by its position in the list. The database runs
+ * in WAL mode and all statements are prepared once in sqlite_open.
+ */
+typedef struct SqliteHandle {
+    sqlite3 *db;
+    sqlite3_stmt *select;
+    sqlite3_stmt *upsert;
+    sqlite3_stmt *trim;
+} SqliteHandle;
+
+static void sqlite_close(Storage *self) {
+    SqliteHandle *h = self->handle;
+    if(!h) return;
+    sqlite3_finalize(h->select);
+    sqlite3_finalize(h->upsert);
+    sqlite3_finalize(h->trim);
+    sqlite3_close(h->db);
+    free(h);
+    self->handle = NULL;
+}
+
+static bool sqlite_open(Storage *self, const char *path) {
+    SqliteHandle *h = calloc(1, sizeof(*h));
+    if(!h) return false;
+    self->handle = h;
+    strncpy(self->path, path, PATH_MAX - 1);
+    self->path[PATH_MAX - 1] = '\0';
+
+    if(sqlite3_open(path, &h->db) != SQLITE_OK ||
+       sqlite3_exec(h->db, "PRAGMA journal_mode=WAL;"
+                           "CREATE TABLE IF NOT EXISTS habits("
+                           "position INTEGER PRIMARY KEY, name TEXT NOT NULL,"
+                           "last_done INTEGER, year INTEGER, history TEXT,"
+                           "remind_at INTEGER DEFAULT -1);",
+                    NULL, NULL, NULL) != SQLITE_OK) {
+        sqlite_close(self);
+        return false;
+    }
+    // Databases created before reminders existed lack the column; ignore the
+    // "duplicate column" error on newer ones.
+    sqlite3_exec(h->db, "ALTER TABLE habits ADD COLUMN remind_at INTEGER DEFAULT -1",
+                 NULL, NULL, NULL);
+
+    if(sqlite3_prepare_v2(h->db, "SELECT name, last_done, year, history, remind_at "
+                                 "FROM habits ORDER BY position LIMIT ?",
+                          -1, &h->select, NULL) != SQLITE_OK ||
+       sqlite3_prepare_v2(h->db, "INSERT OR REPLACE INTO habits "
+                                 "VALUES (?, ?, ?, ?, ?, ?)",
+                          -1, &h->upsert, NULL) != SQLITE_OK ||
+       sqlite3_prepare_v2(h->db, "DELETE FROM habits WHERE position >= ?",
+                          -1, &h->trim, NULL) != SQLITE_OK) {
+        sqlite_close(self);
+        return false;
+    }
+    return true;
+}
+
+static int sqlite_load(Storage *self, Habit *habits, int max) {
+    SqliteHandle *h = self->handle;
+    time_t now = current_time();
+    int current_year = localtime(&now)->tm_year + 1900;
+    int i = 0;
+
+    sqlite3_bind_int(h->select, 1, max);
+    while(i < max && sqlite3_step(h->select) == SQLITE_ROW) {
+        const char *name = (const char *)sqlite3_column_text(h->select, 0);
+        const char *s = (const char *)sqlite3_column_text(h->select, 3);
+        if(!name || !s || sqlite3_column_bytes(h->select, 3) < days_in_year)
+            continue;
+        strncpy(habits[i].name, name, name_max_length - 1);
+        habits[i].name[name_max_length - 1] = '\0';
+        habits[i].last_done = sqlite3_column_int64(h->select, 1);
+        habits[i].year = sqlite3_column_int(h->select, 2);
+        habits[i].remind_at = sqlite3_column_int(h->select, 4);
+        parse_history(&habits[i], s, current_year);
+        i++;
+    }
+    sqlite3_reset(h->select);
+    return i;
+}
+
+static bool sqlite_flush(Storage *self, Habit *habits, int total) {
+    SqliteHandle *h = self->handle;
+    char s[days_in_year];
+    bool ok = sqlite3_exec(h->db, "BEGIN", NULL, NULL, NULL) == SQLITE_OK;
+
+    for(int i = 0; ok && i < total; i++) {
+        for(int j = 0; j < days_in_year; j++)
+            s[j] = habits[i].history[j] ? '1' : '0';
+        sqlite3_bind_int(h->upsert, 1, i);
+        sqlite3_bind_text(h->upsert, 2, habits[i].name, -1, SQLITE_STATIC);
+        sqlite3_bind_int64(h->upsert, 3, habits[i].last_done);
+        sqlite3_bind_int(h->upsert, 4, habits[i].year);
+        sqlite3_bind_text(h->upsert, 5, s, days_in_year, SQLITE_STATIC);
+        sqlite3_bind_int(h->upsert, 6, habits[i].remind_at);
+        ok = sqlite3_step(h->upsert) == SQLITE_DONE;
+        sqlite3_reset(h->upsert);
+    }
+    // Drop rows left over from deleted habits
+    if(ok) {
+        sqlite3_bind_int(h->trim, 1, total);
+        ok = sqlite3_step(h->trim) == SQLITE_DONE;
+        sqlite3_reset(h->trim);
+    }
+    if(ok && sqlite3_exec(h->db, "COMMIT", NULL, NULL, NULL) == SQLITE_OK)
+        return true;
+    sqlite3_exec(h->db, "ROLLBACK", NULL, NULL, NULL);
+    return false;
+}
+#endif
+
+static Storage backends[] = {
+    { "csv", "csv", csv_open, csv_load, csv_flush, csv_close },
+#ifdef USE_SQLITE
+    { "sqlite", "db", sqlite_open, sqlite_load, sqlite_flush, sqlite_close },
+#endif
+};
+
+// Picks the backend named by $HABITS_BACKEND, falling back to CSV
+static Storage *select_storage() {
+    const char *name = getenv("HABITS_BACKEND");
+    if(name == NULL)
+        return &backends[0];
+    for(size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); i++)
+        if(strcmp(backends[i].name, name) == 0)
+            return &backends[i];
+    return NULL;
+}
+
+static void load_habits(Storage *storage, Habit *habits, int *current_total) {
+    *current_total = storage->load(storage, habits, max_habits_amount);
+    for(int i = 0; i < *current_total; i++)
+        if(habits[i].remind_at < 0 || habits[i].remind_at >= minutes_in_day)
+            habits[i].remind_at = no_reminder;
+}
+
+static bool upload_to_disk(Storage *storage, Habit *habits, int current_total) {
+    return storage->flush(storage, habits, current_total);
+}
+
+static double elapsed_us(struct timespec *start)
+{
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) * 1e6 + (end.tv_nsec - start->tv_nsec) / 1e3;
+}
+
+/*
+ * Times load and flush of every compiled-in backend on the same synthetic
+ * habit list (a full list with a random history), in a scratch directory.
+ */
+static bool run_benchmark()
+{
+    char dir[] = "/tmp/habits-bench-XXXXXX";
+    if(!mkdtemp(dir)) {
+        perror("habits: mkdtemp");
+        return false;
+    }
+
+    Habit habits[max_habits_amount], loaded[max_habits_amount];
+    time_t now = current_time();
+    srand(1);
+    for(int i = 0; i < max_habits_amount; i++) {
+        snprintf(habits[i].name, name_max_length, "habit %d", i + 1);
+        habits[i].last_done = now;
+        habits[i].year = localtime(&now)->tm_year + 1900;
+        habits[i].remind_at = i % 2 ? no_reminder : 8 * minutes_in_hour;
+        for(int j = 0; j < days_in_year; j++)
+            habits[i].history[j] = rand() % 2;
+    }
+
+    bool ok = true;
+    printf("%-8s %12s %12s   (%d habits, %d rounds)\n",
+           "backend", "load us", "flush us", max_habits_amount, bench_rounds);
+    for(size_t b = 0; ok && b < sizeof(backends) / sizeof(backends[0]); b++) {
+        Storage storage = backends[b];
+        char path[PATH_MAX];
+        snprintf(path, sizeof(path), "%s/bench.%s", dir, storage.ext);
+        if(!storage.open(&storage, path)) {
+            fprintf(stderr, "habits: cannot open %s storage\n", storage.name);
+            ok = false;
+            break;
+        }
+
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for(int r = 0; ok && r < bench_rounds; r++)
+            ok = upload_to_disk(&storage, habits, max_habits_amount);
+        double flush_us = elapsed_us(&start) / bench_rounds;
+
+        int total = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for(int r = 0; r < bench_rounds; r++)
+            load_habits(&storage, loaded, &total);
+        double load_us = elapsed_us(&start) / bench_rounds;
+
+        if(!ok || total != max_habits_amount) {
+            fprintf(stderr, "habits: %s backend failed the round trip\n", storage.name);
+            ok = false;
+        } else
+            printf("%-8s %12.1f %12.1f\n", storage.name, load_us, flush_us);
+
+        storage.close(&storage);
+        remove(path);
+        for(int k = 0; k < 2; k++) {
+            char extra[PATH_MAX + 8];
+            snprintf(extra, sizeof(extra), "%s%s", path, k ? "-shm" : "-wal");
+            remove(extra);
+        }
+    }
+    rmdir(dir);
+    return ok;
+}
+
+/*
+ * A profile is one named habit list with its own data file. Only profiles
+ * that have been opened are parsed; the most recently used ones stay in
+ * profile_cache so switching back to them does not touch the disk.
+ */
+typedef struct Profile {
+    char name[name_max_length];
+    Storage storage;
+    Habit habits[max_habits_amount];
+    int total;
+    Correlation correlation;
+    unsigned long last_used; // 0 marks a free slot
+} Profile;
+
+static Profile profile_cache[profile_cache_size];
+static unsigned long profile_clock;
+
+static bool valid_profile_name(const char *name) {
+    if(name[0] == '\0' || strlen(name) >= name_max_length)
+        return false;
+    for(const char *p = name; *p; p++)
+        if(!isalnum((unsigned char)*p) && *p != '-' && *p != '_')
+            return false;
+    return true;
+}
+
+// Saves and closes a profile; on a failed save it stays open and cached
+static bool close_profile(Profile *profile) {
+    if(!upload_to_disk(&profile->storage, profile->habits, profile->total))
+        return false;
+    profile->storage.close(&profile->storage);
+    profile->last_used = 0;
+    return true;
+}
+
+static Profile *open_profile(const Storage *backend, const char *name) {
+    Profile *slot = &profile_cache[0];
+    for(int i = 0; i < profile_cache_size; i++) {
+        Profile *p = &profile_cache[i];
+        if(p->last_used && strcmp(p->name, name) == 0) {
+            p->last_used = ++profile_clock;
+            return p;
+        }
+        if(p->last_used < slot->last_used)
+            slot = p;
+    }
+
+    // Miss: reuse a free slot or evict the least recently used profile
+    if(slot->last_used && !close_profile(slot))
+        return NULL;
+
+    char path[PATH_MAX];
+    get_data_path(path, name, backend->ext);
+    slot->storage = *backend;
+    slot->storage.handle = NULL;
+    if(!slot->storage.open(&slot->storage, path))
+        return NULL;
+
+    strncpy(slot->name, name, name_max_length - 1);
+    slot->name[name_max_length - 1] = '\0';
+    load_habits(&slot->storage, slot->habits, &slot->total);
+    invalidate_all_correlations(&slot->correlation);
+    slot->last_used = ++profile_clock;
+    return slot;
+}
+
+// Closes every profile without saving, for commands that only read data
+static void discard_profiles() {
+    for(int i = 0; i < profile_cache_size; i++) {
+        Profile *p = &profile_cache[i];
+        if(p->last_used) {
+            p->storage.close(&p->storage);
+            p->last_used = 0;
+        }
+    }
+}
+
+static bool profile_exists(const Storage *backend, const char *name) {
+    char path[PATH_MAX];
+    get_data_path(path, name, backend->ext);
+    return access(path, F_OK) == 0;
+}
+
+// Called once curses is shut down, so failures can go to stderr
+static bool close_profiles() {
+    bool ok = true;
+    for(int i = 0; i < profile_cache_size; i++) {
+        Profile *p = &profile_cache[i];
+        if(p->last_used && !close_profile(p)) {
+            fprintf(stderr, "habits: cannot save %s\n", p->storage.path);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// Finds the profiles that have a data file for this backend in $HOME
+static int list_profiles(const Storage *backend, char names[][name_max_length], int max) {
+    int count = 0;
+    strcpy(names[count++], DEFAULT_PROFILE);
+
+    const char *home = getenv("HOME");
+    DIR *dir = opendir(home ? home : ".");
+    if(!dir) return count;
+
+    size_t prefix_len = strlen(HABITS_PREFIX "-");
+    size_t ext_len = strlen(backend->ext);
+    struct dirent *entry;
+    while((entry = readdir(dir)) && count < max) {
+        const char *file = entry->d_name;
+        size_t len = strlen(file);
+        if(len <= prefix_len + ext_len + 1 ||
+           strncmp(file, HABITS_PREFIX "-", prefix_len) != 0 ||
+           file[len - ext_len - 1] != '.' ||
+           strcmp(file + len - ext_len, backend->ext) != 0)
+            continue;
+
+        char name[PATH_MAX];
+        snprintf(name, sizeof(name), "%.*s", (int)(len - prefix_len - ext_len - 1), file + prefix_len);
+        if(valid_profile_name(name) && strcmp(name, DEFAULT_PROFILE) != 0)
+            strcpy(names[count++], name);
+    }
+    closedir(dir);
+    return count;
 }
 
 static void action_bar(int rows, int cols)
@@ -213,7 +879,9 @@ static void action_bar(int rows, int cols)
         "2 Delete",
         "3 Rename",
         "4 Calendar",
-        "5 Quit"
+        "5 Quit",
+        "6 Remind",
+        "7 Stats"
     };
     int total_width = 0;
     for(int i = 0; i < menu_count; i++) 
@@ -247,7 +915,7 @@ static bool get_text_input(WINDOW *win, char *buffer, int max_len) {
     wrefresh(win);
 
     while(1) {
-        ch = wgetch(win);
+        ch = read_key(win);
         if(ch == key_escape) {
             curs_set(0);
             return false; // User cancelled
@@ -263,7 +931,7 @@ static bool get_text_input(WINDOW *win, char *buffer, int max_len) {
                 wmove(win, 1, 1 + char_count);         // Move cursor back
             }
         }
-        else if(ch >= 32 && ch <= 126 && char_count < max_len - 1) {
+        else if(ch >= 32 && ch <= 126 && ch != ',' && char_count < max_len - 1) { // ',' splits CSV fields
             buffer[char_count] = (char)ch;
             char_count++;
             buffer[char_count] = '\0';
@@ -275,8 +943,23 @@ static bool get_text_input(WINDOW *win, char *buffer, int max_len) {
     return true;
 }
 
+// Shows `message` centered on a blank screen until a key is pressed
+static void show_message(const char *message)
+{
+    int rows, cols;
+    getmaxyx(stdscr, rows, cols);
+    const char *hint = "Press any key to return.";
+    int x = (cols - (int)strlen(message)) / 2;
+    erase();
+    // Long paths start at the left edge and wrap rather than vanish
+    mvprintw(rows / 2 - 1, x > 0 ? x : 0, "%s", message);
+    mvprintw(rows / 2 + 1, (cols - (int)strlen(hint)) / 2, "%s", hint);
+    refresh();
+    while(read_key(stdscr) == ERR);
+}
+
 static void add_habit(Habit *list, int *current_total) {
-    clear();
+    erase();
     refresh();
 
     int rows, cols;
@@ -285,7 +968,7 @@ static void add_habit(Habit *list, int *current_total) {
     snprintf(message, sizeof(message), "Cannot have more than %d habits. Press any key to return.", max_habits_amount);
     if(*current_total >= max_habits_amount) {
         mvprintw(rows / 2, (cols - strlen(message)) / 2, "%s", message);
-        getch();
+        while(read_key(stdscr) == ERR);
         return;
     }
 
@@ -304,7 +987,7 @@ static void add_habit(Habit *list, int *current_total) {
     dimmed_attr(&attr);
     wattron(win, attr); 
     mvwprintw(win, 1, width - esc_hint_length - 1, ESC_HINT);
-    wattroff(win, attron(attr)); 
+    wattroff(win, attr); 
 
     char temp_name[name_max_length] = {0};
     
@@ -317,9 +1000,10 @@ static void add_habit(Habit *list, int *current_total) {
     strncpy(list[*current_total].name, temp_name, name_max_length - 1);
     list[*current_total].name[name_max_length - 1] = '\0';
     
-    time_t now = time(NULL);
+    time_t now = current_time();
 
     list[*current_total].last_done = 0;
+    list[*current_total].remind_at = no_reminder;
     list[*current_total].year = localtime(&now)->tm_year + 1900;
     for(int i = 0; i < days_in_year; i++)
         list[*current_total].history[i] = false;
@@ -339,7 +1023,7 @@ static void delete_habit(int index, Habit *habits, int *current_total)
 
 static void rename_habit(Habit *habit)
 {
-    clear();
+    erase();
     refresh();
 
     int rows, cols;
@@ -359,7 +1043,7 @@ static void rename_habit(Habit *habit)
     dimmed_attr(&attr);
     wattron(win, attr); 
     mvwprintw(win, 1, width - esc_hint_length - 1, ESC_HINT);
-    wattroff(win, attron(attr)); 
+    wattroff(win, attr); 
     wrefresh(win);
 
     char temp_name[name_max_length] = {0};
@@ -377,9 +1061,167 @@ static void rename_habit(Habit *habit)
     delwin(win);
 }
 
+// Parses "HH:MM" into minutes past midnight; an empty string clears it
+static bool parse_reminder(const char *text, int *remind_at)
+{
+    int hour, minute;
+    char extra;
+    if(text[0] == '\0') {
+        *remind_at = no_reminder;
+        return true;
+    }
+    if(sscanf(text, "%d:%d%c", &hour, &minute, &extra) != 2 ||
+       hour < 0 || hour > 23 || minute < 0 || minute >= minutes_in_hour)
+        return false;
+    *remind_at = hour * minutes_in_hour + minute;
+    return true;
+}
+
+static void set_reminder(Habit *habit)
+{
+    erase();
+    refresh();
+
+    int rows, cols;
+    getmaxyx(stdscr, rows, cols);
+
+    int height = 3;
+    int width = name_max_length + 23;
+    int start_y = (rows - height) / 2;
+    int start_x = (cols - width) / 2;
+
+    WINDOW *win = newwin(height, width, start_y, start_x);
+    keypad(win, TRUE);
+    
+    box(win, 0, 0); 
+    mvwprintw(win, 0, 2, " Remind at HH:MM (empty clears) ");
+
+    int attr;
+    dimmed_attr(&attr);
+    wattron(win, attr); 
+    mvwprintw(win, 1, width - esc_hint_length - 1, ESC_HINT);
+    wattroff(win, attr); 
+    wrefresh(win);
+
+    char temp_time[16] = {0};
+    if(habit->remind_at != no_reminder)
+        snprintf(temp_time, sizeof(temp_time), "%02d:%02d",
+                 habit->remind_at / minutes_in_hour, habit->remind_at % minutes_in_hour);
+    int remind_at;
+    do {
+        if(!get_text_input(win, temp_time, sizeof("HH:MM"))) {
+            delwin(win);
+            return;
+        }
+    } while(!parse_reminder(temp_time, &remind_at));
+    habit->remind_at = remind_at;
+
+    delwin(win);
+}
+
+static bool new_profile_name(char *name)
+{
+    erase();
+    refresh();
+
+    int rows, cols;
+    getmaxyx(stdscr, rows, cols);
+
+    int height = 3;
+    int width = name_max_length + 23;
+    int start_y = (rows - height) / 2;
+    int start_x = (cols - width) / 2;
+
+    WINDOW *win = newwin(height, width, start_y, start_x);
+    keypad(win, TRUE);
+    
+    box(win, 0, 0); 
+    mvwprintw(win, 0, 2, " New profile (a-z, 0-9, - _) ");
+
+    int attr;
+    dimmed_attr(&attr);
+    wattron(win, attr); 
+    mvwprintw(win, 1, width - esc_hint_length - 1, ESC_HINT);
+    wattroff(win, attr); 
+    wrefresh(win);
+
+    char temp_name[name_max_length] = {0};
+    do {
+        if(!get_text_input(win, temp_name, name_max_length)) {
+            delwin(win);
+            return false;
+        }
+    } while(!valid_profile_name(temp_name));
+    strcpy(name, temp_name);
+
+    delwin(win);
+    return true;
+}
+
+// Lets the user choose an existing profile or name a new one
+static bool pick_profile(const Storage *backend, const char *active, char *chosen)
+{
+    char names[profiles_max][name_max_length];
+    int count = list_profiles(backend, names, profiles_max);
+    int highlight = 0;
+    for(int i = 0; i < count; i++)
+        if(strcmp(names[i], active) == 0)
+            highlight = i;
+
+    while(1) {
+        int rows, cols;
+        getmaxyx(stdscr, rows, cols);
+        erase();
+
+        int start_x = (cols - name_max_length) / 2;
+        int start_y = (rows - count - 3) / 2;
+
+        int attr;
+        dimmed_attr(&attr);
+        attron(attr);
+        mvprintw(start_y, start_x - esc_hint_length - 2, ESC_HINT);
+        attroff(attr);
+
+        attron(A_BOLD);
+        mvprintw(start_y, start_x, "PROFILES");
+        attroff(A_BOLD);
+
+        // The extra last row creates a new profile
+        for(int i = 0; i <= count; i++) {
+            bool is_new = (i == count);
+            bool is_active = !is_new && strcmp(names[i], active) == 0;
+            if(i != highlight) attron(attr);
+            mvprintw(start_y + 2 + i, start_x, "%s %s",
+                     is_active ? "*" : " ", is_new ? "+ New profile" : names[i]);
+            if(i != highlight) attroff(attr);
+        }
+        refresh();
+
+        int ch = read_key(stdscr);
+        switch(ch) {
+            case 'k':
+            case KEY_UP:
+                highlight = (highlight + count) % (count + 1);
+                break;
+            case 'j':
+            case KEY_DOWN:
+                highlight = (highlight + 1) % (count + 1);
+                break;
+            case key_enter:
+                if(highlight < count) {
+                    strcpy(chosen, names[highlight]);
+                    return true;
+                }
+                return new_profile_name(chosen);
+            case key_escape:
+                return false;
+        }
+    }
+}
+
 static void print_week_labels(int y, int x)
 {
-    time_t now = time(NULL);
+    time_t now = current_time();
     struct tm *t = localtime(&now);
     int today_wday = t->tm_wday;
 
@@ -406,7 +1248,7 @@ static void print_week_labels(int y, int x)
 static bool confirm_delete(const char *habit_name) {
     int rows, cols;
     getmaxyx(stdscr, rows, cols);
-    clear();
+    erase();
     refresh();
 
     int height = 8;
@@ -452,7 +1294,7 @@ static bool confirm_delete(const char *habit_name) {
     // 5. Input Loop
     bool result = false;
     while (1) {
-        int ch = wgetch(win);
+        int ch = read_key(win);
         if (ch == 'y' || ch == 'Y') {
             result = true;
             break;
@@ -468,7 +1310,7 @@ static bool confirm_delete(const char *habit_name) {
 
 static void draw_calendar(Habit *h) {
     // 1. Setup Time Data
-    time_t now = time(NULL);
+    time_t now = current_time();
     struct tm *t = localtime(&now);
 
     const char *months[] = {
@@ -589,7 +1431,7 @@ static void draw_calendar(Habit *h) {
         attroff(attr);
         refresh();
 
-        int ch = getch();
+        int ch = read_key(stdscr);
         switch(ch) {
             case 'k':   
             case KEY_UP:
@@ -618,21 +1460,90 @@ static void draw_calendar(Habit *h) {
     }
 }
 
-static void draw_status_bar(int rows, int cols, Habit *habits, int total, int view_day) {
-    if (total == 0) return; // Prevent division by zero
+/*
+ * Row A, column B: on days A was done, how often B was done too.
+ * Columns are labelled by the habit's row number to keep the grid narrow.
+ */
+static void draw_stats(Habit *habits, int total, Correlation *corr) {
+    update_correlation(corr, habits, total);
+
+    // The strongest pattern worth spelling out
+    int best_a = -1, best_b = -1, best_pct = 0;
+    for(int a = 0; a < total; a++)
+        for(int b = 0; b < total; b++) {
+            if(a == b || corr->done[a] < min_days_for_pattern) continue;
+            int pct = corr->together[a][b] * 100 / corr->done[a];
+            if(pct > best_pct) {
+                best_pct = pct;
+                best_a = a;
+                best_b = b;
+            }
+        }
 
-    // 1. Calculate counts
-    int completed = 0;
-    
-    // Handle index wrapping (just like in draw_habit_item)
-    int safe_day_idx = view_day;
-    if (safe_day_idx < 0) safe_day_idx += days_in_year;
+    while(1) {
+        int rows, cols;
+        getmaxyx(stdscr, rows, cols);
+        erase();
 
-    for (int i = 0; i < total; i++) {
-        if (habits[i].history[safe_day_idx]) {
-            completed++;
+        int cell = 5;
+        int width = 3 + name_max_length + total * cell;
+        int start_x = (cols - width) / 2;
+        int start_y = (rows - total - 6) / 2;
+
+        int attr;
+        dimmed_attr(&attr);
+        attron(attr);
+        mvprintw(start_y, start_x, ESC_HINT);
+        attroff(attr);
+
+        attron(A_BOLD);
+        mvprintw(start_y, (cols - 13) / 2, " CORRELATION "); // 13 is the length of the string
+        attroff(A_BOLD);
+
+        attron(attr);
+        for(int b = 0; b < total; b++)
+            mvprintw(start_y + 2, start_x + 3 + name_max_length + b * cell, "%4d", b + 1);
+        attroff(attr);
+
+        for(int a = 0; a < total; a++) {
+            int y = start_y + 3 + a;
+            mvprintw(y, start_x, "%2d %s", a + 1, habits[a].name);
+            for(int b = 0; b < total; b++) {
+                move(y, start_x + 3 + name_max_length + b * cell);
+                if(a == b || corr->done[a] == 0) {
+                    attron(attr);
+                    printw("%4s", a == b ? "." : "--");
+                    attroff(attr);
+                    continue;
+                }
+                int pct = corr->together[a][b] * 100 / corr->done[a];
+                int cell_attr = pct >= 75 ? COLOR_PAIR(2) : pct >= 50 ? A_NORMAL : attr;
+                attron(cell_attr);
+                printw("%3d%%", pct);
+                attroff(cell_attr);
+            }
         }
+
+        attron(attr);
+        if(best_a >= 0)
+            mvprintw(start_y + total + 4, start_x, "On days you do '%s' you also do '%s' %d%% of the time.",
+                     habits[best_a].name, habits[best_b].name, best_pct);
+        else
+            mvprintw(start_y + total + 4, start_x, "Not enough history yet.");
+        attroff(attr);
+        refresh();
+
+        int ch = read_key(stdscr);
+        if(ch == key_escape || ch == 'q')
+            return;
     }
+}
+
+static void draw_status_bar(int rows, int cols, Habit *habits, int total, int view_day) {
+    if (total == 0) return; // Prevent division by zero
+
+    // 1. Calculate counts
+    int completed = count_completed(habits, total, view_day);
 
     // 2. Setup Dimensions
     // Width is screen width minus margins (let's say 4 chars padding)
@@ -673,12 +1584,16 @@ static void draw_status_bar(int rows, int cols, Habit *habits, int total, int vi
     else attroff(COLOR_PAIR(9));
 }
 
-static void main_screen(Habit *habits, int *total) {
+static void main_screen(const Storage *backend, Profile *profile) {
+    Habit *habits = profile->habits;
+    int *total = &profile->total;
     int highlight = 0;
-    time_t now = time(NULL);
+    time_t now = current_time();
     int real_today = localtime(&now)->tm_yday;
     int view_day = real_today;
 
+    schedule_reminders(&reminders, habits, *total);
+
     while(1) {
         int r, c;
         getmaxyx(stdscr, r, c);
@@ -690,11 +1605,9 @@ static void main_screen(Habit *habits, int *total) {
             mvprintw(r/2 + 1, (c - 22) / 2, "Please resize window.");
             refresh();
 
-            int ch = getch();
-            if(ch == 'q' || ch == key_escape) {
-                upload_to_disk(habits, *total);
+            int ch = read_key(stdscr);
+            if(ch == 'q' || ch == key_escape)
                 return;
-            }
             continue;
         }
         
@@ -704,6 +1617,14 @@ static void main_screen(Habit *habits, int *total) {
 
         draw_status_bar(r, c, habits, *total, view_day);
 
+        if(strcmp(profile->name, DEFAULT_PROFILE) != 0) {
+            int attr;
+            dimmed_attr(&attr);
+            attron(attr);
+            mvprintw(0, 1, "Profile: %s", profile->name);
+            attroff(attr);
+        }
+
         if(*total == 0)
             mvprintw(list_y, list_x, "No habits found. Press 1 to add.");
         else {
@@ -715,8 +1636,10 @@ static void main_screen(Habit *habits, int *total) {
         action_bar(r, c);
         refresh();
 
-        int ch = getch();
+        // Sleep until a key press or the next reminder, whichever is first
+        int ch = read_key(stdscr);
         switch(ch) {
+            case ERR:
             case KEY_RESIZE:
                 break;
             case 'k':   
@@ -738,12 +1661,16 @@ static void main_screen(Habit *habits, int *total) {
             case '1': 
             case 'a':
                 add_habit(habits, total); 
+                invalidate_all_correlations(&profile->correlation);
+                schedule_reminders(&reminders, habits, *total);
                 break;
             case '2': 
             case 'd':
                 if(*total > 0 && confirm_delete(habits[highlight].name)) {
                     delete_habit(highlight, habits, total);
                     if(highlight >= *total && highlight > 0) highlight--;
+                    invalidate_all_correlations(&profile->correlation);
+                    schedule_reminders(&reminders, habits, *total);
                 }
                 break;
             case '3': 
@@ -752,22 +1679,477 @@ static void main_screen(Habit *habits, int *total) {
                 break;
             case key_enter: 
             case 13: 
-                if(*total > 0) mark_habit_done(&habits[highlight], view_day); 
+                if(*total > 0) {
+                    mark_habit_done(&habits[highlight], view_day); 
+                    invalidate_correlation(&profile->correlation, highlight);
+                }
                 break;
             case '4':
             case 'c':
-                if(*total > 0) draw_calendar(&habits[highlight]);
+                if(*total > 0) {
+                    draw_calendar(&habits[highlight]);
+                    invalidate_correlation(&profile->correlation, highlight);
+                }
+                break;
+            case '6':
+            case 't':
+                if(*total > 0) {
+                    set_reminder(&habits[highlight]);
+                    schedule_reminders(&reminders, habits, *total);
+                }
+                break;
+            case 'p': {
+                char name[name_max_length];
+                if(!pick_profile(backend, profile->name, name) ||
+                   strcmp(name, profile->name) == 0)
+                    break;
+                // Save before switching; the old profile stays cached
+                char message[PATH_MAX + 16];
+                if(!upload_to_disk(&profile->storage, habits, *total)) {
+                    snprintf(message, sizeof(message), "Cannot save %s", profile->storage.path);
+                    show_message(message);
+                    break;
+                }
+                Profile *next = open_profile(backend, name);
+                if(next == NULL) {
+                    snprintf(message, sizeof(message), "Cannot open profile '%s'", name);
+                    show_message(message);
+                    break;
+                }
+                profile = next;
+                habits = profile->habits;
+                total = &profile->total;
+                highlight = 0;
+                schedule_reminders(&reminders, habits, *total);
+                break;
+            }
+            case '7':
+            case 's':
+                if(*total > 0) draw_stats(habits, *total, &profile->correlation);
                 break;
             case '5': 
             case 'q':
             case key_escape:
-                upload_to_disk(habits, *total);
                 endwin(); 
-                exit(0);
+                exit(close_profiles() ? 0 : 1);
         }
     }
 }
 
+// Writes `value` with the characters both output formats need escaped
+static void print_escaped(FILE *out, const char *value)
+{
+    for(const char *p = value; *p; p++) {
+        if(*p == '"' || *p == '\\')
+            fputc('\\', out);
+        fputc(*p, out);
+    }
+}
+
+static void print_metric_header(FILE *out, const char *name, const char *help)
+{
+    fprintf(out, "# HELP %s %s\n# TYPE %s gauge\n", name, help, name);
+}
+
+static void print_habit_label(FILE *out, const char *metric, Habit *habit)
+{
+    fprintf(out, "%s{habit=\"", metric);
+    print_escaped(out, habit->name);
+    fputc('"', out);
+}
+
+static void write_prometheus(FILE *out, Habit *habits, int total, int today)
+{
+    print_metric_header(out, "habit_current_streak_days", "Consecutive days done up to today.");
+    for(int i = 0; i < total; i++) {
+        print_habit_label(out, "habit_current_streak_days", &habits[i]);
+        fprintf(out, "} %d\n", get_streak(habits[i], today));
+    }
+
+    print_metric_header(out, "habit_longest_streak_days", "Longest run of done days this year.");
+    for(int i = 0; i < total; i++) {
+        print_habit_label(out, "habit_longest_streak_days", &habits[i]);
+        fprintf(out, "} %d\n", get_longest_streak(habits[i], today));
+    }
+
+    print_metric_header(out, "habit_completion_window_days",
+                        "Days each completion window covers; shorter in early January.");
+    fprintf(out, "habit_completion_window_days{window=\"%dd\"} %d\n", days_in_week,
+            window_days(today, days_in_week));
+    fprintf(out, "habit_completion_window_days{window=\"%dd\"} %d\n", rolling_window,
+            window_days(today, rolling_window));
+
+    print_metric_header(out, "habit_completion_ratio",
+                        "Share of days done over a rolling window, clipped to this year.");
+    for(int i = 0; i < total; i++) {
+        print_habit_label(out, "habit_completion_ratio", &habits[i]);
+        fprintf(out, ",window=\"%dd\"} %.4f\n", days_in_week,
+                completion_rate(habits[i], today, days_in_week));
+        print_habit_label(out, "habit_completion_ratio", &habits[i]);
+        fprintf(out, ",window=\"%dd\"} %.4f\n", rolling_window,
+                completion_rate(habits[i], today, rolling_window));
+    }
+
+    print_metric_header(out, "habit_done_today", "1 if the habit is done today.");
+    for(int i = 0; i < total; i++) {
+        print_habit_label(out, "habit_done_today", &habits[i]);
+        fprintf(out, "} %d\n", habits[i].history[today]);
+    }
+
+    print_metric_header(out, "habits_completed_today_ratio", "Share of habits done today.");
+    fprintf(out, "habits_completed_today_ratio %.4f\n",
+            total ? (double)count_completed(habits, total, today) / total : 0.0);
+}
+
+static void write_json(FILE *out, Habit *habits, int total, int today)
+{
+    fprintf(out, "{\"completed_today\":%d,\"total\":%d,"
+                 "\"window_7d_days\":%d,\"window_30d_days\":%d,\"habits\":[",
+            count_completed(habits, total, today), total,
+            window_days(today, days_in_week), window_days(today, rolling_window));
+    for(int i = 0; i < total; i++) {
+        fprintf(out, "%s{\"name\":\"", i ? "," : "");
+        print_escaped(out, habits[i].name);
+        fprintf(out, "\",\"current_streak\":%d,\"longest_streak\":%d,"
+                     "\"completion_7d\":%.4f,\"completion_30d\":%.4f,"
+                     "\"done_today\":%s}",
+                get_streak(habits[i], today),
+                get_longest_streak(habits[i], today),
+                completion_rate(habits[i], today, days_in_week),
+                completion_rate(habits[i], today, rolling_window),
+                habits[i].history[today] ? "true" : "false");
+    }
+    fprintf(out, "]}\n");
+}
+
+/*
+ * Headless export for cron jobs and dashboards. The file is written next to
+ * its destination and renamed into place, so readers never see it half done.
+ */
+static bool export_metrics(const char *path, bool json, Habit *habits, int total)
+{
+    char tmp[PATH_MAX];
+    if(snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp))
+        return false;
+
+    FILE *out = fopen(tmp, "w");
+    if(!out) return false;
+
+    time_t now = current_time();
+    int today = localtime(&now)->tm_yday;
+    if(json)
+        write_json(out, habits, total, today);
+    else
+        write_prometheus(out, habits, total, today);
+
+    bool ok = fflush(out) == 0 && fsync(fileno(out)) == 0;
+    ok = fclose(out) == 0 && ok;
+    if(ok && rename(tmp, path) == 0)
+        return true;
+    remove(tmp);
+    return false;
+}
+
+static const int month_days[months_in_year] = {
+    31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+};
+
+static bool is_leap(int year)
+{
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+// Parses "YYYY-MM-DD" by hand; mktime is far too slow for bulk imports
+static bool parse_date(const char *s, int *year, int *yday)
+{
+    for(int i = 0; i < 10; i++) {
+        bool dash = (i == 4 || i == 7);
+        if(dash ? s[i] != '-' : !isdigit((unsigned char)s[i]))
+            return false;
+    }
+    int y = (s[0] - '0') * 1000 + (s[1] - '0') * 100 + (s[2] - '0') * 10 + (s[3] - '0');
+    int m = (s[5] - '0') * 10 + (s[6] - '0');
+    int d = (s[8] - '0') * 10 + (s[9] - '0');
+    if(m < 1 || m > months_in_year || d < 1 ||
+       d > month_days[m - 1] + (m == 2 && is_leap(y)))
+        return false;
+
+    int day = d - 1;
+    for(int i = 0; i < m - 1; i++)
+        day += month_days[i] + (i == 1 && is_leap(y));
+    *year = y;
+    *yday = day;
+    return true;
+}
+
+// Copies a name that may be too long, cutting it only between UTF-8 characters
+static void copy_name(char *dest, const char *src)
+{
+    size_t len = strlen(src);
+    if(len > name_max_length - 1) {
+        len = name_max_length - 1;
+        while(len > 0 && ((unsigned char)src[len] & 0xC0) == 0x80)
+            len--;
+    }
+    memcpy(dest, src, len);
+    dest[len] = '\0';
+}
+
+/*
+ * Finds a habit by name, adding it if there is room; -1 when the list is full.
+ * The CSV data file cannot hold commas in names, so they become semicolons.
+ */
+static int find_or_add_habit(Profile *profile, const char *imported)
+{
+    char name[name_max_length];
+    copy_name(name, imported);
+    for(char *p = name; (p = strchr(p, ',')); )
+        *p = ';';
+
+    for(int i = 0; i < profile->total; i++)
+        if(strcmp(profile->habits[i].name, name) == 0)
+            return i;
+    if(profile->total >= max_habits_amount || name[0] == '\0')
+        return -1;
+
+    time_t now = current_time();
+    Habit *habit = &profile->habits[profile->total];
+    strcpy(habit->name, name);
+    habit->last_done = 0;
+    habit->year = localtime(&now)->tm_year + 1900;
+    habit->remind_at = no_reminder;
+    memset(habit->history, 0, sizeof(habit->history));
+    return profile->total++;
+}
+
+/*
+ * Cuts the next CSV field out of *line. Quoted fields follow RFC 4180:
+ * commas inside quotes are kept and "" stands for one quote. The field is
+ * unescaped in place. Quoted line breaks are not supported.
+ */
+static char *next_field(char **line)
+{
+    char *field = *line;
+    char *p = field;
+    char *out;
+
+    if(*p == '"') {
+        out = field;
+        for(p++; *p; p++) {
+            if(*p == '"' && p[1] != '"') {
+                p++; // Closing quote
+                break;
+            }
+            if(*p == '"')
+                p++; // "" is an escaped quote
+            *out++ = *p;
+        }
+        p += strcspn(p, ",\r\n");
+    } else {
+        p += strcspn(p, ",\r\n");
+        out = p;
+    }
+    *line = (*p == ',') ? p + 1 : p;
+    *out = '\0';
+    return field;
+}
+
+typedef struct ImportStats {
+    long rows;
+    long marked;
+    long skipped;
+    char dropped[dropped_names_max][name_max_length];
+    int dropped_count;
+} ImportStats;
+
+// Warns once per habit that could not be created because the list is full
+static void note_dropped(ImportStats *stats, const char *name)
+{
+    char stored[name_max_length];
+    copy_name(stored, name);
+    for(int i = 0; i < stats->dropped_count && i < dropped_names_max; i++)
+        if(strcmp(stats->dropped[i], stored) == 0)
+            return;
+    if(stats->dropped_count < dropped_names_max) {
+        strcpy(stats->dropped[stats->dropped_count], stored);
+        fprintf(stderr, "habits: habit list is full (%d), skipping '%s'\n",
+                max_habits_amount, name);
+    } else if(stats->dropped_count == dropped_names_max)
+        fprintf(stderr, "habits: skipping more habits, list is full\n");
+    else
+        return;
+    stats->dropped_count++;
+}
+
+static void import_progress(ImportStats *stats)
+{
+    if(stats->rows % import_progress_rows == 0 && isatty(STDERR_FILENO))
+        fprintf(stderr, "\rhabits: %ld rows read", stats->rows);
+}
+
+/*
+ * Loop Habit Tracker's Checkmarks.csv: a "Date" column followed by one
+ * column per habit. Only manual check-ins (2) count as done.
+ */
+static void import_loop(FILE *from, char *header, Profile *profile, ImportStats *stats,
+                        int *last_yday)
+{
+    enum { loop_yes_manual = 2, column_unused = -2, column_dropped = -1 };
+    int columns[max_habits_amount * 4];
+    int column_count = 0;
+
+    char *cursor = header;
+    next_field(&cursor); // "Date"
+    while(*cursor && *cursor != '\n' && column_count < (int)(sizeof(columns) / sizeof(columns[0]))) {
+        char *name = next_field(&cursor);
+        int i = name[0] ? find_or_add_habit(profile, name) : column_unused;
+        if(i == column_dropped)
+            note_dropped(stats, name);
+        columns[column_count++] = i;
+    }
+
+    time_t now = current_time();
+    struct tm *t = localtime(&now);
+    int current_year = t->tm_year + 1900;
+    int today = t->tm_yday;
+    char *line = NULL;
+    size_t size = 0;
+    while(getline(&line, &size, from) != -1) {
+        stats->rows++;
+        import_progress(stats);
+        int year, yday;
+        if(!parse_date(line, &year, &yday) || year != current_year || yday > today) {
+            stats->skipped++;
+            continue;
+        }
+        cursor = line;
+        next_field(&cursor);
+        for(int col = 0; col < column_count && *cursor; col++) {
+            int value = atoi(next_field(&cursor));
+            int i = columns[col];
+            if(value != loop_yes_manual || i == column_unused)
+                continue;
+            if(i == column_dropped) {
+                stats->skipped++;
+                continue;
+            }
+            profile->habits[i].history[yday] = true;
+            if(yday > last_yday[i]) last_yday[i] = yday;
+            stats->marked++;
+        }
+    }
+    free(line);
+}
+
+// Date lists: one "YYYY-MM-DD,Habit name" per line, as written by export
+static void import_dates(FILE *from, char *first, Profile *profile, ImportStats *stats,
+                         int *last_yday)
+{
+    time_t now = current_time();
+    struct tm *t = localtime(&now);
+    int current_year = t->tm_year + 1900;
+    int today = t->tm_yday;
+    char *line = first;
+    size_t size = strlen(first) + 1;
+
+    do {
+        stats->rows++;
+        import_progress(stats);
+        int year, yday;
+        if(!parse_date(line, &year, &yday) || line[10] != ',' ||
+           year != current_year || yday > today) {
+            stats->skipped++;
+            continue;
+        }
+        char *name = line + 11;
+        name[strcspn(name, "\r\n")] = '\0';
+        int i = find_or_add_habit(profile, name);
+        if(i < 0) {
+            if(name[0])
+                note_dropped(stats, name);
+            stats->skipped++;
+            continue;
+        }
+        profile->habits[i].history[yday] = true;
+        if(yday > last_yday[i]) last_yday[i] = yday;
+        stats->marked++;
+    } while(getline(&line, &size, from) != -1);
+    free(line);
+}
+
+/*
+ * Streams another tracker's export into the profile one line at a time,
+ * so memory stays flat however long the history is. Days are OR-ed into
+ * the existing history, so importing the same file twice changes nothing.
+ * Only days of the current year up to today fit the history; the rest,
+ * including future dates, are skipped.
+ */
+static bool import_file(const char *path, Profile *profile)
+{
+    FILE *from = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+    if(!from) return false;
+
+    char *first = NULL;
+    size_t size = 0;
+    if(getline(&first, &size, from) == -1) {
+        free(first);
+        if(from != stdin) fclose(from);
+        return true;
+    }
+
+    int last_yday[max_habits_amount];
+    for(int i = 0; i < max_habits_amount; i++)
+        last_yday[i] = -1;
+    ImportStats stats = {0};
+
+    if(strncmp(first, "Date,", 5) == 0) {
+        import_loop(from, first, profile, &stats, last_yday);
+        free(first);
+    } else
+        import_dates(from, first, profile, &stats, last_yday);
+
+    // Keep last_done in step with the newest imported check-in, never past now
+    time_t now = current_time();
+    for(int i = 0; i < profile->total; i++) {
+        if(last_yday[i] < 0) continue;
+        struct tm day = { .tm_year = profile->habits[i].year - 1900,
+                          .tm_mday = last_yday[i] + 1, .tm_isdst = -1 };
+        time_t when = mktime(&day);
+        if(when > now)
+            when = now;
+        if(when > profile->habits[i].last_done)
+            profile->habits[i].last_done = when;
+    }
+
+    if(from != stdin) fclose(from);
+    fprintf(stderr, "%shabits: %ld rows read, %ld days marked, %ld entries skipped\n",
+            isatty(STDERR_FILENO) && stats.rows >= import_progress_rows ? "\r" : "",
+            stats.rows, stats.marked, stats.skipped);
+    return true;
+}
+
+// Writes every done day as a "YYYY-MM-DD,Habit name" line
+static bool export_file(const char *path, Profile *profile)
+{
+    FILE *dest = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    if(!dest) return false;
+
+    for(int i = 0; i < profile->total; i++) {
+        Habit *habit = &profile->habits[i];
+        int yday = 0;
+        for(int m = 0; m < months_in_year; m++) {
+            int days = month_days[m] + (m == 1 && is_leap(habit->year));
+            for(int d = 1; d <= days; d++, yday++)
+                if(habit->history[yday])
+                    fprintf(dest, "%04d-%02d-%02d,%s\n", habit->year, m + 1, d, habit->name);
+        }
+    }
+    bool ok = fflush(dest) == 0;
+    if(dest != stdout)
+        ok = fclose(dest) == 0 && ok;
+    return ok;
+}
+
 static void init_colors()
 {
     if(!has_colors())
@@ -797,7 +2179,88 @@ static void init_colors()
     }
 }
 
-int main() {
+int main(int argc, char **argv) {
+    const char *export_path = NULL;
+    const char *import_from = NULL;
+    const char *export_to = NULL;
+    const char *profile_name = DEFAULT_PROFILE;
+    bool export_json = false;
+    bool bench = false;
+    for(int i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--bench") == 0)
+            bench = true;
+        else if(i + 1 < argc && (strcmp(argv[i], "-p") == 0 || strcmp(argv[i], "--profile") == 0))
+            profile_name = argv[++i];
+        else if(i + 1 < argc && strcmp(argv[i], "import") == 0)
+            import_from = argv[++i];
+        else if(i + 1 < argc && strcmp(argv[i], "export") == 0)
+            export_to = argv[++i];
+        else if(i + 1 < argc && !export_path && strcmp(argv[i], "--export-prom") == 0)
+            export_path = argv[++i];
+        else if(i + 1 < argc && !export_path && strcmp(argv[i], "--export-json") == 0) {
+            export_path = argv[++i];
+            export_json = true;
+        } else {
+            fprintf(stderr, "usage: habits [-p PROFILE] [import FILE | export FILE |\n"
+                            "              --export-prom PATH | --export-json PATH | --bench]\n");
+            return 1;
+        }
+    }
+    if(bench)
+        return run_benchmark() ? 0 : 1;
+    if(!valid_profile_name(profile_name)) {
+        fprintf(stderr, "habits: invalid profile name '%s'\n", profile_name);
+        return 1;
+    }
+
+    Storage *backend = select_storage();
+    if(backend == NULL) {
+        fprintf(stderr, "habits: unknown storage backend '%s'\n", getenv("HABITS_BACKEND"));
+        return 1;
+    }
+    // Read-only commands must not create a data file for a missing profile
+    if((export_path || export_to) && !profile_exists(backend, profile_name)) {
+        fprintf(stderr, "habits: no data for profile '%s'\n", profile_name);
+        return 1;
+    }
+    Profile *profile = open_profile(backend, profile_name);
+    if(profile == NULL) {
+        fprintf(stderr, "habits: cannot open %s storage\n", backend->name);
+        return 1;
+    }
+
+    if(import_from) {
+        bool ok = import_file(import_from, profile);
+        if(!close_profiles())
+            return 1;
+        if(!ok) {
+            fprintf(stderr, "habits: cannot read %s\n", import_from);
+            return 1;
+        }
+        return 0;
+    }
+
+    if(export_to) {
+        bool ok = export_file(export_to, profile);
+        discard_profiles();
+        if(!ok) {
+            fprintf(stderr, "habits: cannot write %s\n", export_to);
+            return 1;
+        }
+        return 0;
+    }
+
+    if(export_path) {
+        bool ok = export_metrics(export_path, export_json, profile->habits, profile->total);
+        discard_profiles();
+        if(!ok) {
+            fprintf(stderr, "habits: cannot write %s\n", export_path);
+            return 1;
+        }
+        return 0;
+    }
+
+    signal(SIGCHLD, SIG_IGN); // Reminder hooks are never waited on
     initscr();
     cbreak();
     noecho();
@@ -805,12 +2268,8 @@ int main() {
     init_colors();
     curs_set(0);
 
-    int total = 0;
-    Habit my_habits[max_habits_amount];
-
-    load_habits(my_habits, &total);
-    main_screen(my_habits, &total);
+    main_screen(backend, profile);
 
     endwin();
-    return 0;
+    return close_profiles() ? 0 : 1;
 }